@@ -3,6 +3,7 @@
  * Minimally create and display an x11 window SplashPage
  * from a locally defined XPM image file.
  */
+#include <atomic>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
@@ -13,8 +14,10 @@
 #include <malloc.h>
 #include <ncurses.h>
 #include <string>
+#include <strings.h>
 #include <thread>
 #include <unistd.h>
+#include <vector>
 
 #include <X11/Xatom.h>
 #include <X11/Xlib.h>
@@ -40,6 +43,11 @@ Window mSplashWindow;
  * Module Entry.
  */
 int main(int argc, char* argv[]) {
+    // Headless batch render, no X11 Display needed.
+    if (argc >= 2 && strcmp(argv[1], RENDER_OPTION) == 0) {
+        return renderSplashImages(argc - 2, argv + 2);
+    }
+
     // Check for input file.
     if (argc < 2) {
         cout << XCOLOR_RED << endl << "xSplashImage: No " <<
@@ -355,40 +363,55 @@ bool mergeRootImageUnderSplashImage(int xPos, int yPos) {
         }
     }
 
-    for (int h = 0; h < mSplashImage->height; h++) {
-        const int rowI = h * mSplashImage->width * 4;
+    blendBackgroundUnderSplashData(mSplashImage->data,
+        mSplashImage->width, mSplashImage->height,
+        desktopImage->data, desktopImage->bytes_per_line);
 
-        for (int w = 0; w < mSplashImage->width; w++) {
+    XDestroyImage(desktopImage);
+    return true;
+}
+
+/**
+ * Compositing kernel shared by the live & headless paths.
+ * Splash pixels considered transparent (pure black) are
+ * replaced by the background pixel beneath them.
+ */
+void blendBackgroundUnderSplashData(char* splashData,
+    int splashWidth, int splashHeight,
+    const char* backgroundData, int backgroundStride) {
+    for (int h = 0; h < splashHeight; h++) {
+        const int rowI = h * splashWidth * 4;
+        const int backRowI = h * backgroundStride;
+
+        for (int w = 0; w < splashWidth; w++) {
             const int colI = rowI + (w * 4);
+            const int backColI = backRowI + (w * 4);
 
             const unsigned char fromByte0 =
-                *((mSplashImage->data) + colI + 0);
+                *(splashData + colI + 0);
             const unsigned char fromByte1 =
-                *((mSplashImage->data) + colI + 1);
+                *(splashData + colI + 1);
             const unsigned char fromByte2 =
-                *((mSplashImage->data) + colI + 2);
+                *(splashData + colI + 2);
 
             // Copy root pixel if this considered transparent.
             if (fromByte0 == 0x00 && fromByte1 == 0x00 &&
                 fromByte2 == 0x00) {
                 // Blue.
-                *((mSplashImage->data) + colI + 0) =
-                    *((desktopImage->data) + colI + 0);
+                *(splashData + colI + 0) =
+                    *(backgroundData + backColI + 0);
                 // Green.
-                *((mSplashImage->data) + colI + 1) =
-                    *((desktopImage->data) + colI + 1);
+                *(splashData + colI + 1) =
+                    *(backgroundData + backColI + 1);
                 // Red.
-                *((mSplashImage->data) + colI + 2) =
-                    *((desktopImage->data) + colI + 2);
+                *(splashData + colI + 2) =
+                    *(backgroundData + backColI + 2);
                 // Opacity.
-                *((mSplashImage->data) + colI + 3) =
-                    *((desktopImage->data) + colI + 3);
+                *(splashData + colI + 3) =
+                    *(backgroundData + backColI + 3);
             }
         }
     }
-
-    XDestroyImage(desktopImage);
-    return true;
 }
 
 /**
@@ -523,6 +546,306 @@ void sleepWithTimeoutOrKbdPressed(Milliseconds
     }
 }
 
+/**
+ * Headless batch mode. Composites each SplashImage centered
+ * over a background XPM, and writes the results as PPM files,
+ * without any connection to an X11 Display.
+ *
+ *    --render <background.xpm> <outputDir> <splash.xpm> ...
+ */
+bool renderSplashImages(int argc, char* argv[]) {
+    if (argc < 3) {
+        cout << XCOLOR_RED << endl << "xSplashImage: Usage: " <<
+            RENDER_OPTION << " <background.xpm> <outputDir> " <<
+            "<splash.xpm> [splash.xpm ...], FATAL." <<
+            XCOLOR_NORMAL << endl;
+        return true;
+    }
+    const char* BACKGROUND_FILENAME = argv[0];
+    const string OUTPUT_DIRECTORY = argv[1];
+
+    // Read background once, shared read-only by all workers.
+    RenderImage background;
+    if (!readXpmFileToRenderImage(BACKGROUND_FILENAME,
+        &background)) {
+        cout << XCOLOR_RED << "\nxSplashImage: Background file "
+            "invalid or non-existant, FATAL." << XCOLOR_NORMAL <<
+            endl;
+        return true;
+    }
+
+    // Build the batch, rejecting clashing output names.
+    vector<RenderJob> jobs;
+    for (int i = 2; i < argc; i++) {
+        RenderJob job;
+        job.splashFileName = argv[i];
+        job.outputFileName = getRenderOutputFileName(
+            OUTPUT_DIRECTORY, job.splashFileName);
+        for (const RenderJob& OTHER : jobs) {
+            if (OTHER.outputFileName == job.outputFileName) {
+                cout << XCOLOR_RED << "\nxSplashImage: Duplicate "
+                    "output file \"" << job.outputFileName <<
+                    "\", FATAL." << XCOLOR_NORMAL << endl;
+                return true;
+            }
+        }
+        jobs.push_back(job);
+    }
+
+    // Spread the batch across all cores.
+    unsigned threadCount = thread::hardware_concurrency();
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+    if (threadCount > jobs.size()) {
+        threadCount = jobs.size();
+    }
+
+    const chrono::time_point<Clock>
+        START_TIME = Clock::now();
+
+    atomic<size_t> nextJob(0);
+    vector<thread> workers;
+    for (unsigned i = 0; i < threadCount; i++) {
+        workers.emplace_back(renderSplashImageWorker,
+            &background, &jobs, &nextJob);
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+
+    const chrono::time_point<Clock> END_TIME = Clock::now();
+    const Milliseconds TIME_USED = END_TIME - START_TIME;
+
+    // Display logging info.
+    int renderedCount = 0;
+    cout << endl;
+    for (const RenderJob& JOB : jobs) {
+        if (JOB.rendered) {
+            renderedCount++;
+            cout << "Rendered : " << JOB.splashFileName <<
+                " -> " << JOB.outputFileName << "." << endl;
+        } else {
+            cout << XCOLOR_YELLOW << "Failed   : " <<
+                JOB.splashFileName << ", " << JOB.message <<
+                "." << XCOLOR_NORMAL << endl;
+        }
+    }
+
+    const double SECONDS = TIME_USED.count() / 1000.0;
+    cout << endl;
+    cout << "Background size  : " << background.width <<
+        ", " << background.height << "." << endl;
+    cout << "Worker threads   : " << threadCount << "." << endl;
+    cout << "Images rendered  : " << renderedCount << " of " <<
+        jobs.size() << "." << endl;
+    cout << "Elapsed time     : " << TIME_USED.count() <<
+        " ms." << endl;
+    cout << "Images / second  : " << (SECONDS > 0 ?
+        renderedCount / SECONDS : 0) << "." << endl;
+    cout << endl;
+
+    return renderedCount != (int) jobs.size();
+}
+
+/**
+ * Worker thread for the headless batch. Claims jobs until
+ * the batch is drained.
+ */
+void renderSplashImageWorker(const RenderImage* background,
+    vector<RenderJob>* jobs, atomic<size_t>* nextJob) {
+    size_t jobI;
+    while ((jobI = (*nextJob)++) < jobs->size()) {
+        RenderJob& job = (*jobs)[jobI];
+
+        RenderImage splash;
+        if (!readXpmFileToRenderImage(job.splashFileName.c_str(),
+            &splash)) {
+            job.message = "input file invalid or non-existant";
+            continue;
+        }
+        if (splash.width > background->width ||
+            splash.height > background->height) {
+            job.message = "larger than background";
+            continue;
+        }
+
+        // Same centering & blend as the live path.
+        const int CENTER_X = (background->width -
+            splash.width) / 2;
+        const int CENTER_Y = (background->height -
+            splash.height) / 2;
+        const int BACKGROUND_STRIDE = background->width * 4;
+        const int CENTER_I = (CENTER_Y * BACKGROUND_STRIDE) +
+            (CENTER_X * 4);
+        blendBackgroundUnderSplashData(splash.data.data(),
+            splash.width, splash.height,
+            background->data.data() + CENTER_I,
+            BACKGROUND_STRIDE);
+
+        // Place merged SplashImage onto a copy of background.
+        RenderImage merged = *background;
+        for (int h = 0; h < splash.height; h++) {
+            memcpy(merged.data.data() + CENTER_I +
+                (h * BACKGROUND_STRIDE),
+                splash.data.data() + (h * splash.width * 4),
+                splash.width * 4);
+        }
+
+        if (!writeRenderImageToPpmFile(
+            job.outputFileName.c_str(), merged)) {
+            job.message = "can\'t write output file";
+            continue;
+        }
+        job.rendered = true;
+    }
+}
+
+/**
+ * Helper method to build the output file name for a
+ * SplashImage, <outputDir>/<basename>.ppm.
+ */
+string getRenderOutputFileName(const string& outputDirectory,
+    const string& splashFileName) {
+    string baseName = splashFileName;
+    const size_t SLASH_I = baseName.find_last_of('/');
+    if (SLASH_I != string::npos) {
+        baseName = baseName.substr(SLASH_I + 1);
+    }
+    const size_t DOT_I = baseName.find_last_of('.');
+    if (DOT_I != string::npos && DOT_I > 0) {
+        baseName = baseName.substr(0, DOT_I);
+    }
+    return outputDirectory + "/" + baseName + ".ppm";
+}
+
+/**
+ * Helper method to read an XPM file into a BGRA buffer
+ * laid out like the ZPixmap XImage of the live path.
+ */
+bool readXpmFileToRenderImage(const char* fileName,
+    RenderImage* image) {
+    XpmImage xpmImage;
+    if (XpmReadFileToXpmImage((char*) fileName, &xpmImage,
+        NULL) != XpmSuccess) {
+        return false;
+    }
+
+    // Resolve the color table once, then index into it.
+    vector<unsigned char> colors(xpmImage.ncolors * 4);
+    for (unsigned int i = 0; i < xpmImage.ncolors; i++) {
+        const XpmColor* COLOR = &xpmImage.colorTable[i];
+        const char* COLOR_NAME = COLOR->c_color ? COLOR->c_color :
+            COLOR->g_color ? COLOR->g_color :
+            COLOR->g4_color ? COLOR->g4_color : COLOR->m_color;
+        if (!parseXpmColorToBGRA(COLOR_NAME, &colors[i * 4])) {
+            cout << XCOLOR_YELLOW << "\nxSplashImage: Can\'t "
+                "resolve XPM color \"" << (COLOR_NAME ?
+                COLOR_NAME : "") << "\" without a Display, "
+                "use #RRGGBB." << XCOLOR_NORMAL << endl;
+            XpmFreeXpmImage(&xpmImage);
+            return false;
+        }
+    }
+
+    image->width = xpmImage.width;
+    image->height = xpmImage.height;
+    image->data.resize(xpmImage.width * xpmImage.height * 4);
+    for (unsigned int p = 0; p < xpmImage.width *
+        xpmImage.height; p++) {
+        const unsigned int COLOR_I = xpmImage.data[p];
+        if (COLOR_I >= xpmImage.ncolors) {
+            XpmFreeXpmImage(&xpmImage);
+            return false;
+        }
+        memcpy(&image->data[p * 4], &colors[COLOR_I * 4], 4);
+    }
+
+    XpmFreeXpmImage(&xpmImage);
+    return true;
+}
+
+/**
+ * Helper method to parse an XPM color into BGRA bytes.
+ * "None" maps to black, as XpmReadFileToImage does, so
+ * it stays transparent to the compositing kernel.
+ */
+bool parseXpmColorToBGRA(const char* colorName,
+    unsigned char* bgra) {
+    if (!colorName) {
+        return false;
+    }
+    if (strcasecmp(colorName, "None") == 0) {
+        memset(bgra, 0, 4);
+        return true;
+    }
+    if (colorName[0] != '#') {
+        return false;
+    }
+
+    // #RGB, #RRGGBB, #RRRGGGBBB, or #RRRRGGGGBBBB.
+    const char* HEX = colorName + 1;
+    const size_t HEX_LENGTH = strlen(HEX);
+    if (HEX_LENGTH == 0 || HEX_LENGTH % 3 != 0 ||
+        HEX_LENGTH > 12) {
+        return false;
+    }
+    for (size_t i = 0; i < HEX_LENGTH; i++) {
+        if (!isxdigit(HEX[i])) {
+            return false;
+        }
+    }
+
+    const size_t DIGITS = HEX_LENGTH / 3;
+    unsigned int rgb[3];
+    for (int c = 0; c < 3; c++) {
+        const string CHANNEL(HEX + (c * DIGITS), DIGITS);
+        unsigned int value = strtoul(CHANNEL.c_str(), NULL, 16);
+        // Scale the channel to 8 bits.
+        if (DIGITS == 1) {
+            value *= 0x11;
+        } else {
+            value >>= (DIGITS - 2) * 4;
+        }
+        rgb[c] = value;
+    }
+
+    bgra[0] = rgb[2];
+    bgra[1] = rgb[1];
+    bgra[2] = rgb[0];
+    bgra[3] = 0x00;
+    return true;
+}
+
+/**
+ * Helper method to write a BGRA buffer as a binary
+ * PPM (P6) file.
+ */
+bool writeRenderImageToPpmFile(const char* fileName,
+    const RenderImage& image) {
+    ofstream outFile(fileName, ios::binary);
+    if (!outFile) {
+        return false;
+    }
+
+    outFile << "P6\n" << image.width << " " <<
+        image.height << "\n255\n";
+
+    vector<char> row(image.width * 3);
+    for (int h = 0; h < image.height; h++) {
+        const char* FROM = image.data.data() +
+            (h * image.width * 4);
+        for (int w = 0; w < image.width; w++) {
+            row[(w * 3) + 0] = FROM[(w * 4) + 2];
+            row[(w * 3) + 1] = FROM[(w * 4) + 1];
+            row[(w * 3) + 2] = FROM[(w * 4) + 0];
+        }
+        outFile.write(row.data(), row.size());
+    }
+
+    return outFile.good();
+}
+
 /**
  * This method traps and handles X11 errors.
  */
@@ -22,6 +22,28 @@ enum class DMType {
     SDDM
 };
 
+#define RENDER_OPTION "--render"
+
+/**
+ * Headless BGRA image, laid out like a 32 bit
+ * ZPixmap XImage (Blue, Green, Red, Pad).
+ */
+struct RenderImage {
+    int width = 0;
+    int height = 0;
+    vector<char> data;
+};
+
+/**
+ * One SplashImage of a headless batch render.
+ */
+struct RenderJob {
+    string splashFileName;
+    string outputFileName;
+    bool rendered = false;
+    string message;
+};
+
 #define XCOLOR_NORMAL "\033[0m"
 #define XCOLOR_BLACK "\033[0;30m"
 #define XCOLOR_WHITE "\033[0;37m"
@@ -45,6 +67,9 @@ string getWMNameFromRootWindow(Window rootWindow);
 
 string getDisplayManagerName();
 bool mergeRootImageUnderSplashImage(int xPos, int yPos);
+void blendBackgroundUnderSplashData(char* splashData,
+    int splashWidth, int splashHeight,
+    const char* backgroundData, int backgroundStride);
 XImage* createBlackXImage();
 
 // Display & helpers.
@@ -54,6 +79,19 @@ bool isMouseClickedAndHeldInWindow(Window splashImage);
 void sleepWithTimeoutOrKbdPressed(Milliseconds
     timeoutValue);
 
+// Headless batch render & helpers.
+bool renderSplashImages(int argc, char* argv[]);
+void renderSplashImageWorker(const RenderImage* background,
+    vector<RenderJob>* jobs, atomic<size_t>* nextJob);
+string getRenderOutputFileName(const string& outputDirectory,
+    const string& splashFileName);
+bool readXpmFileToRenderImage(const char* fileName,
+    RenderImage* image);
+bool parseXpmColorToBGRA(const char* colorName,
+    unsigned char* bgra);
+bool writeRenderImageToPpmFile(const char* fileName,
+    const RenderImage& image);
+
 // Framework & debug.
 int handleX11ErrorEvent(Display* display,
     XErrorEvent* event);